@@ -0,0 +1,91 @@
+#include "json_pool.h"
+#include "cJSON.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <assert.h>
+#include <stdint.h>
+
+#define TAG "json_pool"
+#define POOL_SIZE CONFIG_POWER_INDICATOR_JSON_POOL_SIZE
+
+/** Alignment of each allocation. cJSON stores doubles, so use 8 bytes. */
+#define POOL_ALIGNMENT 8
+
+/**
+ * The pool replaces the cJSON allocator for the whole image and has no locking. It is owned by the
+ * first task to call @c json_pool_reset() (the MQTT task) and must only be used from that task;
+ * any other cJSON user would corrupt it.
+ */
+struct json_pool
+{
+    TaskHandle_t owner; /**< Only task allowed to allocate from or reset the pool. */
+    uint8_t buffer[POOL_SIZE] __attribute__((aligned(POOL_ALIGNMENT)));
+    size_t used;       /**< Bytes handed out since the last reset. */
+    size_t high_water; /**< Largest value of @c used since boot. */
+};
+
+static struct json_pool pool;
+
+static void *pool_malloc(size_t size)
+{
+    assert(pool.owner == xTaskGetCurrentTaskHandle());
+
+    size_t aligned_size = (size + POOL_ALIGNMENT - 1) & ~(size_t)(POOL_ALIGNMENT - 1);
+
+    if (aligned_size > POOL_SIZE - pool.used)
+    {
+        ESP_LOGW(TAG, "Pool exhausted (%zu bytes requested, %zu of %d used)", size, pool.used,
+                 POOL_SIZE);
+        return NULL;
+    }
+
+    void *ptr = &pool.buffer[pool.used];
+    pool.used += aligned_size;
+    if (pool.used > pool.high_water)
+    {
+        pool.high_water = pool.used;
+    }
+
+    return ptr;
+}
+
+/** Individual allocations are released all at once by @c json_pool_reset(). */
+static void pool_free(void *ptr)
+{
+    (void)ptr;
+}
+
+bool json_pool_init(void)
+{
+    cJSON_Hooks hooks = {
+        .malloc_fn = pool_malloc,
+        .free_fn = pool_free,
+    };
+
+    cJSON_InitHooks(&hooks);
+    pool.used = 0;
+
+    return true;
+}
+
+void json_pool_reset(void)
+{
+    if (!pool.owner)
+    {
+        pool.owner = xTaskGetCurrentTaskHandle();
+    }
+    assert(pool.owner == xTaskGetCurrentTaskHandle());
+
+    pool.used = 0;
+}
+
+size_t json_pool_size(void)
+{
+    return POOL_SIZE;
+}
+
+size_t json_pool_high_water(void)
+{
+    return pool.high_water;
+}
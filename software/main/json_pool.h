@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Route all cJSON allocations into a static pool.
+ *
+ * Allocations are handed out sequentially and are never freed individually; the whole pool is
+ * released by @c json_pool_reset(). The pool has no locking: the first task to call
+ * @c json_pool_reset() owns it, and using cJSON from any other task trips an assert.
+ *
+ * @note Must be called before any other cJSON function.
+ *
+ * @return @c true on success, else @c false.
+ */
+bool json_pool_init(void);
+
+/**
+ * Release every allocation made from the pool.
+ *
+ * @note Any cJSON objects parsed before this call must no longer be in use.
+ */
+void json_pool_reset(void);
+
+/**
+ * Get the size of the pool.
+ *
+ * @return Pool size in bytes.
+ */
+size_t json_pool_size(void);
+
+/**
+ * Get the largest number of bytes used from the pool since boot.
+ *
+ * @return Pool high watermark in bytes.
+ */
+size_t json_pool_high_water(void);
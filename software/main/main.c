@@ -7,6 +7,10 @@
 
 #include "indicator.h"
 #include "network.h"
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+#include "json_pool.h"
+#include "memory_budget.h"
+#endif
 
 static const char *TAG = "power-indicator";
 
@@ -18,6 +22,14 @@ enum indicator_colour_specifier power_colours[CONFIG_LED_MATRIX_HEIGHT] = {
 #define NETWORK_STATUS_INDEX 0
 #define MQTT_STATUS_INDEX 1
 
+/** Whether the fragments currently being received belong to the energy topic. */
+static bool receiving_energy_topic;
+
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+/** Buffer used to reassemble energy updates larger than the MQTT receive buffer. */
+static char energy_update[CONFIG_POWER_INDICATOR_ENERGY_UPDATE_MAX_SIZE];
+#endif
+
 static void handle_range(int row_idx, cJSON *object)
 {
     cJSON *value = cJSON_GetObjectItem(object, "value");
@@ -54,6 +66,10 @@ static void handle_percent(int row_idx, cJSON *object)
 
 static void process_energy_topic(const char *json_data, size_t json_length)
 {
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+    json_pool_reset();
+#endif
+
     cJSON *root = cJSON_ParseWithLength(json_data, json_length);
     if (!root)
     {
@@ -119,11 +135,49 @@ static void handle_mqtt_event_data(esp_mqtt_event_handle_t event)
     ESP_LOGI(TAG, "TOPIC=%.*s, Data Len:%d", event->topic_len, event->topic, event->data_len);
     ESP_LOGD(TAG, "DATA=%.*s", event->data_len, event->data);
 
-    if (event->topic_len == strlen(CONFIG_ENERGY_TOPIC)
-        && strncmp(event->topic, CONFIG_ENERGY_TOPIC, event->topic_len) == 0)
+    /* The topic is only provided with the first fragment of a message. */
+    if (event->current_data_offset == 0)
+    {
+        bool length_match = event->topic_len == strlen(CONFIG_ENERGY_TOPIC);
+        receiving_energy_topic =
+            length_match && strncmp(event->topic, CONFIG_ENERGY_TOPIC, event->topic_len) == 0;
+    }
+
+    if (!receiving_energy_topic)
+    {
+        return;
+    }
+
+    if (event->total_data_len == event->data_len)
     {
         process_energy_topic(event->data, event->data_len);
+        return;
     }
+
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+    if (event->total_data_len > sizeof(energy_update)
+        || event->current_data_offset + event->data_len > event->total_data_len)
+    {
+        if (event->current_data_offset == 0)
+        {
+            ESP_LOGE(TAG, "Energy update (%d bytes) exceeds the update buffer (%d bytes), dropping",
+                     event->total_data_len, (int)sizeof(energy_update));
+        }
+        receiving_energy_topic = false;
+        return;
+    }
+
+    memcpy(&energy_update[event->current_data_offset], event->data, event->data_len);
+
+    if (event->current_data_offset + event->data_len == event->total_data_len)
+    {
+        process_energy_topic(energy_update, event->total_data_len);
+    }
+#else
+    ESP_LOGE(TAG, "Energy update (%d bytes) exceeds the MQTT buffer (%d bytes), dropping",
+             event->total_data_len, event->data_len);
+    receiving_energy_topic = false;
+#endif
 }
 
 /**
@@ -216,6 +270,11 @@ static void mqtt_app_start(void)
         .broker.address.uri = CONFIG_BROKER_URL,
         .credentials.username = CONFIG_BROKER_USERNAME,
         .credentials.authentication.password = CONFIG_BROKER_PASSWORD,
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+        .buffer.size = CONFIG_POWER_INDICATOR_MQTT_BUFFER_SIZE,
+        .buffer.out_size = CONFIG_POWER_INDICATOR_MQTT_OUT_BUFFER_SIZE,
+        .task.stack_size = CONFIG_POWER_INDICATOR_MQTT_TASK_STACK_SIZE,
+#endif
     };
 
     esp_mqtt_client_handle_t client = esp_mqtt_client_init(&mqtt_cfg);
@@ -265,6 +324,15 @@ void app_main(void)
     }
     ESP_ERROR_CHECK(ret);
 
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+    ok = json_pool_init();
+    if (!ok)
+    {
+        ESP_LOGE(TAG, "JSON pool initialisation failed.");
+        error_trap();
+    }
+#endif
+
     ok = indicator_init(CONFIG_POWER_INDICATOR_DATA_PIN);
     if (!ok)
     {
@@ -278,5 +346,17 @@ void app_main(void)
         error_trap();
     }
 
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+    memory_budget_mark_mqtt_init();
+#endif
+
     mqtt_app_start();
+
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+    ok = memory_budget_start();
+    if (!ok)
+    {
+        ESP_LOGE(TAG, "memory budget check failed to start.");
+    }
+#endif
 }
@@ -0,0 +1,150 @@
+#include "memory_budget.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "json_pool.h"
+
+#define TAG "memory_budget"
+
+#define HEAP_BUDGET CONFIG_POWER_INDICATOR_HEAP_BUDGET
+#define CHECK_PERIOD_MS CONFIG_POWER_INDICATOR_MEMORY_CHECK_PERIOD_MS
+
+#define MONITOR_STACK_SIZE 3072
+#define MONITOR_PRIORITY (tskIDLE_PRIORITY + 1)
+
+/** Name of the task created by the ESP-MQTT client. */
+#define MQTT_TASK_NAME "mqtt_task"
+/** Warn if a task has less than this many bytes of stack left unused. */
+#define STACK_HEADROOM 512
+
+/** Heap the build-time report assumes ESP-MQTT allocates during initialisation. */
+#define MQTT_HEAP_BUDGET                                                                           \
+    (CONFIG_POWER_INDICATOR_MQTT_BUFFER_SIZE + CONFIG_POWER_INDICATOR_MQTT_OUT_BUFFER_SIZE         \
+     + CONFIG_POWER_INDICATOR_MQTT_TASK_STACK_SIZE)
+
+struct memory_budget
+{
+    TaskHandle_t task;
+    StaticTask_t task_buffer;
+    StackType_t stack[MONITOR_STACK_SIZE];
+    size_t mqtt_init_free_heap; /**< Free heap before the MQTT client was initialised. */
+    size_t boot_free_heap;      /**< Free heap once all subsystems were initialised. */
+};
+
+static struct memory_budget budget;
+
+static void check_mqtt_init(void)
+{
+    if (!budget.mqtt_init_free_heap || budget.mqtt_init_free_heap < budget.boot_free_heap)
+    {
+        return;
+    }
+
+    size_t mqtt_heap = budget.mqtt_init_free_heap - budget.boot_free_heap;
+    ESP_LOGI(TAG, "MQTT initialisation used %zu bytes of heap, report assumes %d for buffers and "
+                  "task stack",
+             mqtt_heap, MQTT_HEAP_BUDGET);
+
+    if (mqtt_heap < (size_t)MQTT_HEAP_BUDGET)
+    {
+        ESP_LOGW(TAG, "MQTT used less heap than its configured buffers, check the MQTT config");
+    }
+}
+
+static void check_heap(void)
+{
+    size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t min_free_heap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    long drift = (long)budget.boot_free_heap - (long)free_heap;
+
+    ESP_LOGI(TAG, "Heap free=%zu, drift since boot=%ld, lifetime low watermark=%zu, budget=%d",
+             free_heap, drift, min_free_heap, HEAP_BUDGET);
+
+    if (min_free_heap < (size_t)HEAP_BUDGET)
+    {
+        ESP_LOGW(TAG, "Heap low watermark (%zu) is below the budget (%d)", min_free_heap,
+                 HEAP_BUDGET);
+    }
+}
+
+static void check_json_pool(void)
+{
+    size_t high_water = json_pool_high_water();
+    size_t size = json_pool_size();
+
+    ESP_LOGI(TAG, "JSON pool high watermark=%zu of %zu", high_water, size);
+
+    if (size - high_water < size / 4)
+    {
+        ESP_LOGW(TAG, "JSON pool is over 75%% used, consider increasing its size");
+    }
+}
+
+/**
+ * Check the stack headroom of a task.
+ *
+ * @param name Name of the task, used for logging.
+ * @param task Handle of the task to check, or NULL for the calling task.
+ * @param stack_size Size of the task's stack in bytes.
+ */
+static void check_stack(const char *name, TaskHandle_t task, size_t stack_size)
+{
+    UBaseType_t unused = uxTaskGetStackHighWaterMark(task);
+    ESP_LOGI(TAG, "Task '%s' stack unused=%u of %zu", name, unused, stack_size);
+
+    if (unused < STACK_HEADROOM)
+    {
+        ESP_LOGW(TAG, "Task '%s' is close to overflowing its stack", name);
+    }
+}
+
+static void memory_budget_task(void *arg)
+{
+    (void)arg;
+
+    check_mqtt_init();
+
+    while (1)
+    {
+        check_heap();
+        check_json_pool();
+
+        TaskHandle_t mqtt_task = xTaskGetHandle(MQTT_TASK_NAME);
+        if (mqtt_task)
+        {
+            check_stack(MQTT_TASK_NAME, mqtt_task, CONFIG_POWER_INDICATOR_MQTT_TASK_STACK_SIZE);
+        }
+        check_stack(pcTaskGetName(NULL), NULL, MONITOR_STACK_SIZE);
+
+        vTaskDelay(pdMS_TO_TICKS(CHECK_PERIOD_MS));
+    }
+}
+
+void memory_budget_mark_mqtt_init(void)
+{
+    budget.mqtt_init_free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+bool memory_budget_start(void)
+{
+    if (budget.task)
+    {
+        ESP_LOGW(TAG, "Memory budget check already started.");
+        return true;
+    }
+
+    budget.boot_free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    ESP_LOGI(TAG, "Free heap after boot=%zu, budget=%d", budget.boot_free_heap, HEAP_BUDGET);
+
+    budget.task = xTaskCreateStatic(memory_budget_task, "memory_budget", MONITOR_STACK_SIZE, NULL,
+                                    MONITOR_PRIORITY, budget.stack, &budget.task_buffer);
+    if (!budget.task)
+    {
+        ESP_LOGE(TAG, "Failed to create memory budget task.");
+        return false;
+    }
+
+    return true;
+}
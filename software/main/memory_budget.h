@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * Record the free heap before the MQTT client is initialised.
+ *
+ * The heap used by the MQTT client is then compared with the Kconfig-sized buffers and task stack
+ * assumed by the build-time memory report.
+ *
+ * @note Call immediately before initialising the MQTT client.
+ */
+void memory_budget_mark_mqtt_init(void);
+
+/**
+ * Start checking heap usage against the configured memory budget.
+ *
+ * Records the free heap at the time of the call as the post-boot baseline and starts a statically
+ * allocated task that periodically compares the heap watermarks with the budget.
+ *
+ * @note Call once all other subsystems have been initialised.
+ *
+ * @return @c true if succesful, else @c false
+ */
+bool memory_budget_start(void);
@@ -0,0 +1,99 @@
+# Build-time report of the RAM used by each subsystem.
+#
+# The static column sums the .bss/.data symbols of each object in the main component. The boot-time
+# heap column adds the buffers that ESP-MQTT and the Wi-Fi driver allocate once during
+# initialisation, sized from sdkconfig.
+#
+# Expects NM, OBJECTS ('|' separated), MQTT_BUFFER_SIZE, MQTT_OUT_BUFFER_SIZE,
+# MQTT_TASK_STACK_SIZE, WIFI_STATIC_RX_BUFFER_NUM, WIFI_STATIC_TX_BUFFER_NUM and HEAP_BUDGET to be
+# defined.
+
+# Size of each Wi-Fi driver RX/TX buffer.
+set(WIFI_BUFFER_SIZE 1600)
+
+set(subsystems indicator network mqtt parser app monitor)
+foreach(subsystem ${subsystems})
+    set(${subsystem}_static 0)
+    set(${subsystem}_heap 0)
+endforeach()
+
+string(REPLACE "|" ";" OBJECTS "${OBJECTS}")
+
+foreach(object ${OBJECTS})
+    get_filename_component(name ${object} NAME)
+    if(name MATCHES "^indicator\\.")
+        set(subsystem indicator)
+    elseif(name MATCHES "^network\\.")
+        set(subsystem network)
+    elseif(name MATCHES "^main\\.")
+        set(subsystem app)
+    elseif(name MATCHES "^json_pool\\.")
+        set(subsystem parser)
+    elseif(name MATCHES "^memory_budget\\.")
+        set(subsystem monitor)
+    else()
+        continue()
+    endif()
+
+    execute_process(COMMAND ${NM} --print-size --radix=d ${object}
+                    OUTPUT_VARIABLE symbols
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(WARNING "Failed to read symbols from ${object}")
+        continue()
+    endif()
+
+    string(REPLACE "\n" ";" symbols "${symbols}")
+    foreach(symbol ${symbols})
+        # <value> <size> <type> <name>; b/B/d/D/C are the symbols that live in RAM.
+        if(symbol MATCHES "^[0-9]+ ([0-9]+) [bBdDC] ")
+            math(EXPR ${subsystem}_static "${${subsystem}_static} + ${CMAKE_MATCH_1}")
+        endif()
+    endforeach()
+endforeach()
+
+math(EXPR mqtt_heap "${MQTT_BUFFER_SIZE} + ${MQTT_OUT_BUFFER_SIZE} + ${MQTT_TASK_STACK_SIZE}")
+math(EXPR network_heap
+     "(${WIFI_STATIC_RX_BUFFER_NUM} + ${WIFI_STATIC_TX_BUFFER_NUM}) * ${WIFI_BUFFER_SIZE}")
+
+function(pad_left out width value)
+    string(LENGTH "${value}" length)
+    while(length LESS width)
+        set(value " ${value}")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+set(total_static 0)
+set(total_heap 0)
+
+message("Power Indicator RAM report (bytes):")
+message("  subsystem      static  boot-time heap")
+foreach(subsystem ${subsystems} total)
+    if(subsystem STREQUAL "total")
+        set(static ${total_static})
+        set(heap ${total_heap})
+    else()
+        set(static ${${subsystem}_static})
+        set(heap ${${subsystem}_heap})
+        math(EXPR total_static "${total_static} + ${static}")
+        math(EXPR total_heap "${total_heap} + ${heap}")
+    endif()
+
+    string(LENGTH "${subsystem}" length)
+    math(EXPR padding "11 - ${length}")
+    string(REPEAT " " ${padding} padding)
+    pad_left(static 10 "${static}")
+    pad_left(heap 16 "${heap}")
+    message("  ${subsystem}${padding}${static}${heap}")
+endforeach()
+
+message("  app: main.c, MQTT event handling and the energy update buffer")
+message("  mqtt: ${MQTT_BUFFER_SIZE} in + ${MQTT_OUT_BUFFER_SIZE} out buffers, "
+        "${MQTT_TASK_STACK_SIZE} task stack")
+message("  network: ${WIFI_STATIC_RX_BUFFER_NUM} static RX + ${WIFI_STATIC_TX_BUFFER_NUM} "
+        "static TX Wi-Fi buffers of ${WIFI_BUFFER_SIZE}")
+message("  Not included: neopixel_Init() and RMT driver state, Wi-Fi/lwIP control structures,"
+        " and per-message allocations (dynamic Wi-Fi buffers, lwIP pbufs, MQTT events).")
+message("  Minimum free heap budget (checked at runtime, separate from the above): ${HEAP_BUDGET}")
@@ -52,6 +52,9 @@
 
 /* FreeRTOS event group to signal when we are connected*/
 static EventGroupHandle_t s_wifi_event_group;
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+static StaticEventGroup_t s_wifi_event_group_buffer;
+#endif
 
 /* The event group allows multiple bits for each event, but we only care about two events:
  * - we are connected to the AP with an IP
@@ -95,7 +98,11 @@ static void event_handler(void *arg, esp_event_base_t event_base, int32_t event_
 
 static bool wifi_init_sta(void)
 {
+#if CONFIG_POWER_INDICATOR_STATIC_ALLOCATION
+    s_wifi_event_group = xEventGroupCreateStatic(&s_wifi_event_group_buffer);
+#else
     s_wifi_event_group = xEventGroupCreate();
+#endif
 
     ESP_ERROR_CHECK(esp_netif_init());
 